@@ -0,0 +1,11 @@
+#include <cstddef>
+#include <iostream>
+
+std::size_t bench_use_a();
+std::size_t bench_use_b();
+
+int main()
+{
+    std::cout << "Serialized " << bench_use_a() + bench_use_b() << " bytes" << std::endl;
+    return 0;
+}
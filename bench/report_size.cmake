@@ -0,0 +1,9 @@
+# Reports the archive and executable sizes of the compile time benchmark variants.
+cmake_minimum_required(VERSION 3.14)
+
+file(SIZE "${INLINE}" inline_size)
+file(SIZE "${EXTERN}" extern_size)
+file(SIZE "${INLINE_EXE}" inline_exe_size)
+file(SIZE "${EXTERN_EXE}" extern_exe_size)
+message(STATUS "Implicit instantiation: archive ${inline_size} bytes, executable ${inline_exe_size} bytes")
+message(STATUS "Explicit instantiation: archive ${extern_size} bytes, executable ${extern_exe_size} bytes")
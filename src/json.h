@@ -1,8 +1,12 @@
 #pragma once
+#include "p_json_array_stream.h"
+#include "p_json_parse_cache.h"
 #include "p_json_parser.h"
+#include "p_json_scatter_gather.h"
 #include "p_json_serializer.h"
 #include <iostream>
 #include <iterator>
+#include <sstream>
 #include <string>
 
 namespace mini_json
@@ -19,19 +23,81 @@ template <typename Class, typename T> constexpr auto property(T Class::*member,
      that returns a tuple of the the json properties to be parsed.
      Parsed properties must be able to be set by the parse method
      (declare them as public)
+     Nesting deeper than options.max_depth raises DepthLimitExceeded
      */
-template <typename T, typename FwIt> T parse(FwIt begin, FwIt end)
+template <typename T, typename FwIt> T parse(FwIt begin, FwIt end, ParseOptions options = {})
 {
     static_assert(_private::IsJsonParseble<T>::value,
                   "Type must specify 'json_properties' static member "
                   "function to be used in this context!");
-    auto parser = _private::ParseImpl<FwIt>{begin, end};
+    auto parser = _private::ParseImpl<FwIt>{begin, end, options};
     return parser.template parse<T>(_private::Type<T>{});
 }
 
-template <typename T> T parse(std::istream& stream)
+template <typename T> T parse(std::istream& stream, ParseOptions options = {})
 {
-    return parse<T>(std::istream_iterator<char>(stream), std::istream_iterator<char>());
+    return parse<T>(std::istream_iterator<char>(stream), std::istream_iterator<char>(), options);
+}
+
+/**
+     Update target in place from a json patch
+     Properties missing from the patch keep their current value,
+     nested objects are patched recursively while vectors are replaced as a whole
+     */
+template <typename T, typename FwIt>
+void apply_patch(FwIt begin, FwIt end, T& target, ParseOptions options = {})
+{
+    static_assert(_private::IsJsonParseble<T>::value,
+                  "Type must specify 'json_properties' static member "
+                  "function to be used in this context!");
+    auto parser = _private::ParseImpl<FwIt>{begin, end, options};
+    parser.patch(target);
+}
+
+template <typename T> void apply_patch(std::istream& stream, T& target, ParseOptions options = {})
+{
+    apply_patch(std::istream_iterator<char>(stream), std::istream_iterator<char>(), target,
+                options);
+}
+
+/**
+     Parse a json array of T into struct-of-arrays storage
+     Each property of T is collected into its own contiguous column,
+     properties missing from an element keep the value of a default constructed T
+     */
+template <typename T, typename FwIt>
+Columns<T> parse_columns(FwIt begin, FwIt end, ParseOptions options = {})
+{
+    static_assert(_private::IsJsonParseble<T>::value,
+                  "Type must specify 'json_properties' static member "
+                  "function to be used in this context!");
+    auto parser = _private::ParseImpl<FwIt>{begin, end, options};
+    return parser.parse(_private::Type<Columns<T>>{});
+}
+
+template <typename T> Columns<T> parse_columns(std::istream& stream, ParseOptions options = {})
+{
+    return parse_columns<T>(std::istream_iterator<char>(stream), std::istream_iterator<char>(),
+                            options);
+}
+
+/**
+     Parse a json array of T one element at a time
+     Returns an input range that yields each element as it is parsed,
+     so only a single element is held in memory at any time
+     */
+template <typename T, typename FwIt>
+ArrayStream<T, FwIt> stream_array(FwIt begin, FwIt end, ParseOptions options = {})
+{
+    return ArrayStream<T, FwIt>(begin, end, options);
+}
+
+template <typename T>
+ArrayStream<T, std::istream_iterator<char>> stream_array(std::istream& stream,
+                                                         ParseOptions options = {})
+{
+    return stream_array<T>(std::istream_iterator<char>(stream), std::istream_iterator<char>(),
+                           options);
 }
 
 /**
@@ -49,5 +115,59 @@ template <typename T, typename OStream> void serialize(T const& item, OStream& r
     auto serializer = _private::SerializerImpl<OStream>(result);
     serializer.serialize(item);
 }
+
+/**
+     Serialize only the properties of current that differ from baseline
+     Nested objects are diffed recursively, vectors and maps that differ in any element
+     are written out in full. Apply the result to a copy of baseline with apply_patch
+     */
+template <typename T, typename OStream>
+void serialize_diff(T const& current, T const& baseline, OStream& result)
+{
+    static_assert(_private::IsJsonParseble<T>::value,
+                  "Type must specify 'json_properties' static member "
+                  "function to be used in this context!");
+    auto serializer = _private::SerializerImpl<OStream>(result);
+    serializer.serialize_diff(current, baseline);
+}
+
+/**
+     Serialize columnar storage as a json array of objects
+     */
+template <typename T, typename OStream> void serialize(Columns<T> const& columns, OStream& result)
+{
+    auto serializer = _private::SerializerImpl<OStream>(result);
+    serializer.serialize(columns);
+}
 } // namespace mini_json
 
+/**
+     Explicit instantiation of parse and serialize for a json type T
+     Place the MINI_JSON_EXTERN_* declarations next to the definition of T and
+     the matching MINI_JSON_INSTANTIATE_* definitions in exactly one translation unit,
+     so the parser and serializer of T are compiled only once.
+     MINI_JSON_*_PARSE(T, FwIt) and MINI_JSON_*_SERIALIZE(T, OStream) cover a single variant,
+     MINI_JSON_*_TYPE(T) covers parsing from std::string iterators and std::istream
+     and serializing to std::ostream, std::stringstream and std::ostringstream.
+     All of them must be used at global scope
+     */
+#define MINI_JSON_EXPLICIT_PARSE_(PREFIX, T, FwIt)                                                 \
+    PREFIX template T mini_json::parse<T, FwIt>(FwIt, FwIt, mini_json::ParseOptions);
+
+#define MINI_JSON_EXPLICIT_SERIALIZE_(PREFIX, T, OStream)                                          \
+    PREFIX template void mini_json::serialize<T, OStream>(T const&, OStream&);
+
+#define MINI_JSON_EXPLICIT_TYPE_(PREFIX, T)                                                        \
+    MINI_JSON_EXPLICIT_PARSE_(PREFIX, T, std::string::const_iterator)                              \
+    MINI_JSON_EXPLICIT_PARSE_(PREFIX, T, std::string::iterator)                                    \
+    MINI_JSON_EXPLICIT_PARSE_(PREFIX, T, std::istream_iterator<char>)                              \
+    MINI_JSON_EXPLICIT_SERIALIZE_(PREFIX, T, std::ostream)                                         \
+    MINI_JSON_EXPLICIT_SERIALIZE_(PREFIX, T, std::stringstream)                                    \
+    MINI_JSON_EXPLICIT_SERIALIZE_(PREFIX, T, std::ostringstream)
+
+#define MINI_JSON_EXTERN_PARSE(T, FwIt) MINI_JSON_EXPLICIT_PARSE_(extern, T, FwIt)
+#define MINI_JSON_INSTANTIATE_PARSE(T, FwIt) MINI_JSON_EXPLICIT_PARSE_(, T, FwIt)
+#define MINI_JSON_EXTERN_SERIALIZE(T, OStream) MINI_JSON_EXPLICIT_SERIALIZE_(extern, T, OStream)
+#define MINI_JSON_INSTANTIATE_SERIALIZE(T, OStream) MINI_JSON_EXPLICIT_SERIALIZE_(, T, OStream)
+#define MINI_JSON_EXTERN_TYPE(T) MINI_JSON_EXPLICIT_TYPE_(extern, T)
+#define MINI_JSON_INSTANTIATE_TYPE(T) MINI_JSON_EXPLICIT_TYPE_(, T)
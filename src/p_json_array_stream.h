@@ -0,0 +1,124 @@
+#pragma once
+#include "p_json_parser.h"
+#include "p_json_utility.h"
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace mini_json
+{
+/**
+     Lazily parses the elements of a json array one at a time.
+     Only the most recently parsed element is held in memory,
+     leaving the loop early stops parsing the rest of the input.
+     The array itself counts as one level towards ParseOptions::max_depth, like in parse.
+     The stream refers to itself while parsing, so it can be neither copied nor moved
+     */
+template <typename T, typename FwIt> class ArrayStream
+{
+    FwIt first;
+    FwIt last;
+    _private::ParseImpl<FwIt> parser;
+    std::optional<T> current = std::nullopt;
+    bool started = false;
+
+    void advance()
+    {
+        if (!started)
+        {
+            started = true;
+            parser.enter_level();
+            parser.open_array();
+        }
+        else
+        {
+            parser.close_element();
+        }
+        if (parser.has_next_element())
+        {
+            current.emplace(parser.parse(_private::Type<T>{}));
+        }
+        else
+        {
+            current.reset();
+        }
+    }
+
+public:
+    class iterator
+    {
+        ArrayStream* stream;
+
+        bool at_end() const
+        {
+            return stream == nullptr || !stream->current;
+        }
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        explicit iterator(ArrayStream* stream)
+            : stream(stream)
+        {
+        }
+
+        reference operator*() const
+        {
+            return *stream->current;
+        }
+
+        pointer operator->() const
+        {
+            return &*stream->current;
+        }
+
+        iterator& operator++()
+        {
+            stream->advance();
+            return *this;
+        }
+
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(iterator const& other) const
+        {
+            return at_end() == other.at_end();
+        }
+
+        bool operator!=(iterator const& other) const
+        {
+            return !operator==(other);
+        }
+    };
+
+    ArrayStream(FwIt begin, FwIt end, ParseOptions options = {})
+        : first(begin)
+        , last(end)
+        , parser(first, last, options)
+    {
+    }
+    ArrayStream(ArrayStream const&) = delete;
+    ArrayStream& operator=(ArrayStream const&) = delete;
+
+    iterator begin()
+    {
+        if (!started)
+        {
+            advance();
+        }
+        return iterator{this};
+    }
+
+    iterator end()
+    {
+        return iterator{nullptr};
+    }
+};
+} // namespace mini_json
@@ -0,0 +1,107 @@
+#pragma once
+#include "p_json_utility.h"
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mini_json
+{
+/**
+     Struct-of-arrays storage for a sequence of T
+     Every property returned by T::json_properties is stored
+     in its own contiguous std::vector, in the order of the properties.
+     All columns always hold the same number of rows
+     */
+template <typename T> class Columns
+{
+public:
+    using Properties = typename _private::PropertyTable<T>::Properties;
+    constexpr static std::size_t column_count = _private::PropertyTable<T>::size;
+
+private:
+    template <typename Seq> struct Storage;
+    template <std::size_t... I> struct Storage<std::index_sequence<I...>>
+    {
+        using type = std::tuple<std::vector<typename std::tuple_element_t<I, Properties>::Type>...>;
+    };
+
+    typename Storage<std::make_index_sequence<column_count>>::type columns;
+    std::size_t rows = 0;
+
+public:
+    template <std::size_t I> auto& column()
+    {
+        return std::get<I>(columns);
+    }
+
+    template <std::size_t I> auto const& column() const
+    {
+        return std::get<I>(columns);
+    }
+
+    /// Column of the given data member, throws std::invalid_argument if it is not a json property
+    template <typename U> std::vector<U>& column(U T::*member)
+    {
+        std::vector<U>* result = nullptr;
+        _private::for_sequence(std::make_index_sequence<column_count>{}, [&](auto i) {
+            constexpr auto property = std::get<i>(_private::PropertyTable<T>::properties);
+            if constexpr (std::is_same_v<typename decltype(property)::Type, U>)
+            {
+                if (property.member == member)
+                {
+                    result = &std::get<i>(columns);
+                }
+            }
+        });
+        if (result == nullptr)
+        {
+            throw std::invalid_argument("Member is not a json property of this type!");
+        }
+        return *result;
+    }
+
+    template <typename U> std::vector<U> const& column(U T::*member) const
+    {
+        return const_cast<Columns&>(*this).column(member);
+    }
+
+    std::size_t size() const
+    {
+        return rows;
+    }
+
+    bool empty() const
+    {
+        return rows == 0;
+    }
+
+    void reserve(std::size_t n)
+    {
+        _private::for_sequence(std::make_index_sequence<column_count>{},
+                               [&](auto i) { std::get<i>(columns).reserve(n); });
+    }
+
+    void push_back(T const& item)
+    {
+        _private::for_sequence(std::make_index_sequence<column_count>{}, [&](auto i) {
+            constexpr auto property = std::get<i>(_private::PropertyTable<T>::properties);
+            std::get<i>(columns).push_back(item.*(property.member));
+        });
+        ++rows;
+    }
+
+    /// Gathers the row at index back into a T
+    T row(std::size_t index) const
+    {
+        auto result = T{};
+        _private::for_sequence(std::make_index_sequence<column_count>{}, [&](auto i) {
+            constexpr auto property = std::get<i>(_private::PropertyTable<T>::properties);
+            result.*(property.member) = std::get<i>(columns)[index];
+        });
+        return result;
+    }
+};
+} // namespace mini_json
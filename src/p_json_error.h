@@ -30,5 +30,15 @@ struct UnexpectedPropertyName : public ParseError
     UnexpectedPropertyName(UnexpectedPropertyName const&) = default;
     UnexpectedPropertyName& operator=(UnexpectedPropertyName const&) = default;
 };
+
+struct DepthLimitExceeded : public ParseError
+{
+    DepthLimitExceeded(std::string msg)
+        : ParseError(std::move(msg))
+    {
+    }
+    DepthLimitExceeded(DepthLimitExceeded const&) = default;
+    DepthLimitExceeded& operator=(DepthLimitExceeded const&) = default;
+};
 } // namespace mini_json
 
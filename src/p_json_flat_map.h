@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mini_json
+{
+/**
+     String keyed map with open addressing for json objects with dynamic keys
+     Entries are stored contiguously in insertion order, lookups probe
+     a separate power of two sized table of entry indices.
+     Lookups take std::string_view so no key has to be copied.
+     Entries can not be erased individually
+     */
+template <typename V> class FlatMap
+{
+public:
+    using value_type = std::pair<std::string, V>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+    constexpr static auto empty_slot = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<value_type> entries;
+    std::vector<std::uint32_t> slots;
+
+    std::size_t slot_of(std::string_view key) const
+    {
+        const auto mask = slots.size() - 1;
+        auto slot = std::hash<std::string_view>{}(key) & mask;
+        while (slots[slot] != empty_slot && entries[slots[slot]].first != key)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void rehash(std::size_t n_slots)
+    {
+        slots.assign(n_slots, empty_slot);
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            slots[slot_of(entries[i].first)] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+public:
+    /// Prepares the map to hold n entries without rehashing
+    void reserve(std::size_t n)
+    {
+        entries.reserve(n);
+        auto n_slots = std::size_t{8};
+        while (n_slots < n * 2)
+        {
+            n_slots *= 2;
+        }
+        if (n_slots > slots.size())
+        {
+            rehash(n_slots);
+        }
+    }
+
+    V& insert_or_assign(std::string key, V value)
+    {
+        if ((entries.size() + 1) * 2 > slots.size())
+        {
+            rehash(slots.empty() ? 8 : slots.size() * 2);
+        }
+        const auto slot = slot_of(key);
+        if (slots[slot] != empty_slot)
+        {
+            return entries[slots[slot]].second = std::move(value);
+        }
+        slots[slot] = static_cast<std::uint32_t>(entries.size());
+        entries.emplace_back(std::move(key), std::move(value));
+        return entries.back().second;
+    }
+
+    V* find(std::string_view key)
+    {
+        if (slots.empty())
+        {
+            return nullptr;
+        }
+        const auto slot = slots[slot_of(key)];
+        return slot == empty_slot ? nullptr : &entries[slot].second;
+    }
+
+    V const* find(std::string_view key) const
+    {
+        return const_cast<FlatMap&>(*this).find(key);
+    }
+
+    V& at(std::string_view key)
+    {
+        auto result = find(key);
+        if (result == nullptr)
+        {
+            throw std::out_of_range("Key not found in FlatMap!");
+        }
+        return *result;
+    }
+
+    V const& at(std::string_view key) const
+    {
+        return const_cast<FlatMap&>(*this).at(key);
+    }
+
+    bool contains(std::string_view key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    std::size_t size() const
+    {
+        return entries.size();
+    }
+
+    bool empty() const
+    {
+        return entries.empty();
+    }
+
+    void clear()
+    {
+        entries.clear();
+        slots.clear();
+    }
+
+    const_iterator begin() const
+    {
+        return entries.begin();
+    }
+
+    const_iterator end() const
+    {
+        return entries.end();
+    }
+
+    bool operator==(FlatMap const& other) const
+    {
+        if (size() != other.size())
+        {
+            return false;
+        }
+        for (auto& entry : entries)
+        {
+            auto value = other.find(entry.first);
+            if (value == nullptr || !(*value == entry.second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(FlatMap const& other) const
+    {
+        return !operator==(other);
+    }
+};
+} // namespace mini_json
@@ -0,0 +1,147 @@
+#pragma once
+#include "p_json_parser.h"
+#include "p_json_utility.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mini_json::_private
+{
+/// 64 bit FNV-1a
+inline std::uint64_t hash_bytes(std::string_view bytes)
+{
+    auto hash = std::uint64_t{14695981039346656037ull};
+    for (auto c : bytes)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+} // namespace mini_json::_private
+
+namespace mini_json
+{
+/**
+     Caches parsed values of T keyed by the content of the json input
+     Byte-identical inputs share a single immutable T.
+     The cache holds at most capacity entries in total, split over up to Shards shards
+     that each evict their least recently used entry, lookups only lock the shard
+     the input hashes to. The bound counts entries, not bytes: every entry keeps
+     a copy of its json input next to the parsed value
+     */
+template <typename T, std::size_t Shards = 16> class ParseCache
+{
+    static_assert(_private::IsJsonParseble<T>::value,
+                  "Type must specify 'json_properties' static member "
+                  "function to be used in this context!");
+    static_assert(Shards > 0, "ParseCache needs at least one shard!");
+
+    struct Entry
+    {
+        std::uint64_t hash;
+        std::string json;
+        std::shared_ptr<T const> value;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::size_t capacity = 0;
+        std::list<Entry> entries;
+        std::unordered_map<std::uint64_t, typename std::list<Entry>::iterator> index;
+    };
+
+    std::array<Shard, Shards> shards;
+    std::size_t active_shards;
+    ParseOptions options;
+
+public:
+    /// Caches up to capacity documents, a capacity of 0 disables caching
+    explicit ParseCache(std::size_t capacity, ParseOptions options = {})
+        : active_shards(std::max<std::size_t>(1, std::min(capacity, Shards)))
+        , options(options)
+    {
+        for (std::size_t i = 0; i < active_shards; ++i)
+        {
+            shards[i].capacity = capacity / active_shards + (i < capacity % active_shards ? 1 : 0);
+        }
+    }
+    ParseCache(ParseCache const&) = delete;
+    ParseCache& operator=(ParseCache const&) = delete;
+
+    /// Returns the cached value for json, parsing and caching it on a miss
+    std::shared_ptr<T const> parse(std::string_view json)
+    {
+        const auto hash = _private::hash_bytes(json);
+        auto& shard = shards[hash % active_shards];
+        {
+            auto lock = std::lock_guard<std::mutex>{shard.mutex};
+            auto it = shard.index.find(hash);
+            if (it != shard.index.end() && it->second->json == json)
+            {
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                return it->second->value;
+            }
+        }
+
+        auto begin = json.begin();
+        auto parser = _private::ParseImpl<std::string_view::const_iterator>{begin, json.end(),
+                                                                            options};
+        auto value = std::make_shared<T const>(parser.parse(_private::Type<T>{}));
+
+        auto lock = std::lock_guard<std::mutex>{shard.mutex};
+        auto it = shard.index.find(hash);
+        if (it != shard.index.end())
+        {
+            if (it->second->json == json)
+            {
+                shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+                return it->second->value;
+            }
+            shard.entries.erase(it->second);
+            shard.index.erase(it);
+        }
+        if (shard.capacity == 0)
+        {
+            return value;
+        }
+        if (shard.entries.size() >= shard.capacity)
+        {
+            shard.index.erase(shard.entries.back().hash);
+            shard.entries.pop_back();
+        }
+        shard.entries.push_front(Entry{hash, std::string{json}, value});
+        shard.index.emplace(hash, shard.entries.begin());
+        return value;
+    }
+
+    std::size_t size()
+    {
+        auto result = std::size_t{0};
+        for (auto& shard : shards)
+        {
+            auto lock = std::lock_guard<std::mutex>{shard.mutex};
+            result += shard.entries.size();
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        for (auto& shard : shards)
+        {
+            auto lock = std::lock_guard<std::mutex>{shard.mutex};
+            shard.index.clear();
+            shard.entries.clear();
+        }
+    }
+};
+} // namespace mini_json
@@ -1,13 +1,29 @@
 #pragma once
+#include "p_json_columns.h"
 #include "p_json_error.h"
+#include "p_json_flat_map.h"
 #include "p_json_utility.h"
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <map>
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
+namespace mini_json
+{
+struct ParseOptions
+{
+    /// Maximum nesting depth of objects and arrays, deeper input raises DepthLimitExceeded
+    std::size_t max_depth = 256;
+};
+} // namespace mini_json
+
 namespace mini_json::_private
 {
 template <typename FwIt> class ParseImpl
@@ -19,9 +35,28 @@ template <typename FwIt> class ParseImpl
         Value
     };
 
-    ParseState state = ParseState::Default;
+    class DepthGuard
+    {
+        std::size_t& depth;
+
+    public:
+        DepthGuard(ParseImpl& parser)
+            : depth(parser.depth)
+        {
+            parser.enter_level();
+        }
+        DepthGuard(DepthGuard const&) = delete;
+        DepthGuard& operator=(DepthGuard const&) = delete;
+        ~DepthGuard()
+        {
+            --depth;
+        }
+    };
+
     FwIt& begin;
     FwIt end;
+    ParseOptions options;
+    std::size_t depth = 0;
 
 public:
     using ParseState = ParseState;
@@ -39,15 +74,27 @@ public:
         return c == ',';
     }
 
-    ParseImpl(FwIt& begin, FwIt end)
+    ParseImpl(FwIt& begin, FwIt end, ParseOptions options = {})
         : begin(begin)
         , end(end)
+        , options(options)
     {
     }
 
     template <typename T> T parse(Type<T>);
 
     template <typename T> std::vector<T> parse(Type<std::vector<T>>);
+    template <typename T> Columns<T> parse(Type<Columns<T>>);
+
+    template <typename V, typename Compare, typename Alloc>
+    std::map<std::string, V, Compare, Alloc> parse(Type<std::map<std::string, V, Compare, Alloc>>);
+    template <typename V, typename Hash, typename Equal, typename Alloc>
+    std::unordered_map<std::string, V, Hash, Equal, Alloc>
+        parse(Type<std::unordered_map<std::string, V, Hash, Equal, Alloc>>);
+    template <typename V> FlatMap<V> parse(Type<FlatMap<V>>);
+
+    /// Parses into an existing value, nested objects only overwrite the properties present
+    template <typename T> void patch(T& target);
 
     int parse(Type<int>);
     unsigned parse(Type<unsigned>);
@@ -55,18 +102,61 @@ public:
     double parse(Type<double>);
     std::string parse(Type<std::string>);
 
+    /// Counts a level opened outside of parse, such as a streamed array, towards max_depth
+    /// for the remaining lifetime of the parser
+    void enter_level();
+    /// Consumes the opening bracket of an array
+    void open_array();
+    /// Returns true if another array element follows, consumes the closing bracket otherwise
+    bool has_next_element();
+    /// Consumes the separator following an array element
+    void close_element();
+
 private:
     template <typename TResult> TResult parse_float();
     void throw_unexpected_character(char chr);
     template <typename Fun> void skip_until(Fun&& predicate);
     template <typename T> void init();
+    template <typename T, typename Fun> void parse_object(Fun&& parse_property);
+    template <typename Map> Map parse_map();
+    std::size_t count_members();
     void assert_correct_value_end(char ending);
 };
 
 template <typename FwIt> template <typename T> T ParseImpl<FwIt>::parse(Type<T>)
 {
-    init<T>();
     auto result = T{};
+    parse_object<T>([&](auto i) {
+        constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+        using PropertyType = typename decltype(property)::Type;
+        (PropertyType&)(result.*(property.member)) = this->parse(Type<PropertyType>{});
+    });
+    return result;
+}
+
+template <typename FwIt> template <typename T> void ParseImpl<FwIt>::patch(T& target)
+{
+    if constexpr (IsJsonParseble<T>::value)
+    {
+        parse_object<T>([&](auto i) {
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            using PropertyType = typename decltype(property)::Type;
+            this->patch((PropertyType&)(target.*(property.member)));
+        });
+    }
+    else
+    {
+        target = parse(Type<T>{});
+    }
+}
+
+template <typename FwIt>
+template <typename T, typename Fun>
+void ParseImpl<FwIt>::parse_object(Fun&& parse_property)
+{
+    auto guard = DepthGuard{*this};
+    init<T>();
+    auto state = ParseState::Default;
     std::string key{};
     while (begin != end)
     {
@@ -81,7 +171,7 @@ template <typename FwIt> template <typename T> T ParseImpl<FwIt>::parse(Type<T>)
             else if (*begin == '}')
             {
                 ++begin;
-                return result;
+                return;
             }
             else
             {
@@ -105,11 +195,7 @@ template <typename FwIt> template <typename T> T ParseImpl<FwIt>::parse(Type<T>)
             }
             break;
         case ParseState::Value:
-            executeByPropertyName<T>(key.c_str(), [&](auto property) {
-                using PropertyType = typename decltype(property)::Type;
-                (PropertyType&)(result.*(property.member)) =
-                    ParseImpl<FwIt>{begin, end}.parse(Type<PropertyType>{});
-            });
+            executeByPropertyIndex<T>(key.c_str(), parse_property);
             state = ParseState::Default;
             key.clear();
             skip_until([](auto c) { return !is_white_space(c); });
@@ -125,21 +211,167 @@ template <typename FwIt>
 template <typename T>
 std::vector<T> ParseImpl<FwIt>::parse(Type<std::vector<T>>)
 {
+    auto guard = DepthGuard{*this};
+    open_array();
+    auto result = std::vector<T>{};
+    while (has_next_element())
+    {
+        result.push_back(parse(Type<T>{}));
+        close_element();
+    }
+    return result;
+}
+
+template <typename FwIt>
+template <typename T>
+Columns<T> ParseImpl<FwIt>::parse(Type<Columns<T>>)
+{
+    static const auto defaults = T{};
+    auto guard = DepthGuard{*this};
+    open_array();
+    auto result = Columns<T>{};
+    while (has_next_element())
+    {
+        result.push_back(defaults);
+        parse_object<T>([&](auto i) {
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            using PropertyType = typename decltype(property)::Type;
+            result.template column<i>().back() = this->parse(Type<PropertyType>{});
+        });
+        close_element();
+    }
+    return result;
+}
+
+template <typename FwIt>
+template <typename V, typename Compare, typename Alloc>
+std::map<std::string, V, Compare, Alloc>
+    ParseImpl<FwIt>::parse(Type<std::map<std::string, V, Compare, Alloc>>)
+{
+    return parse_map<std::map<std::string, V, Compare, Alloc>>();
+}
+
+template <typename FwIt>
+template <typename V, typename Hash, typename Equal, typename Alloc>
+std::unordered_map<std::string, V, Hash, Equal, Alloc>
+    ParseImpl<FwIt>::parse(Type<std::unordered_map<std::string, V, Hash, Equal, Alloc>>)
+{
+    return parse_map<std::unordered_map<std::string, V, Hash, Equal, Alloc>>();
+}
+
+template <typename FwIt> template <typename V> FlatMap<V> ParseImpl<FwIt>::parse(Type<FlatMap<V>>)
+{
+    return parse_map<FlatMap<V>>();
+}
+
+template <typename FwIt> template <typename Map> Map ParseImpl<FwIt>::parse_map()
+{
+    using ValueType = std::decay_t<decltype(std::declval<Map&>().begin()->second)>;
+    auto guard = DepthGuard{*this};
     skip_until([](auto c) { return !is_white_space(c); });
-    if (*begin != '[')
+    if (begin == end)
+    {
+        throw ParseError("Unexpected end to the json input!");
+    }
+    if (*begin != '{')
     {
         throw_unexpected_character(*begin);
     }
     ++begin;
-    auto result = std::vector<T>{};
-    while (*begin != ']')
+    auto result = Map{};
+    if constexpr (HasReserve<Map>::value)
+    {
+        result.reserve(count_members());
+    }
+    while (true)
     {
-        result.push_back(parse(Type<T>{}));
         skip_until([](auto c) { return !is_white_space(c); });
-        assert_correct_value_end(']');
+        if (begin == end)
+        {
+            throw ParseError("Unexpected end to the json input!");
+        }
+        if (*begin == '}')
+        {
+            ++begin;
+            return result;
+        }
+        auto key = parse(Type<std::string>{});
+        skip_until([](auto c) { return !is_white_space(c); });
+        if (begin == end || *begin != ':')
+        {
+            throw ParseError("Expected ':' after key [" + key + "] in json input!");
+        }
+        ++begin;
+        auto value = parse(Type<ValueType>{});
+        result.insert_or_assign(std::move(key), std::move(value));
+        skip_until([](auto c) { return !is_white_space(c); });
+        if (begin == end)
+        {
+            throw ParseError("Unexpected end to the json input!");
+        }
+        assert_correct_value_end('}');
+    }
+}
+
+/// Counts the members of the object at the current position without consuming input
+/// Only possible for multi-pass iterators, returns 0 for single pass input
+template <typename FwIt> std::size_t ParseImpl<FwIt>::count_members()
+{
+    using Category = typename std::iterator_traits<FwIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+    {
+        auto nesting = 0;
+        auto in_string = false;
+        auto escaped = false;
+        auto has_member = false;
+        auto count = std::size_t{0};
+        for (auto it = begin; it != end; ++it)
+        {
+            const char c = *it;
+            if (in_string)
+            {
+                if (escaped)
+                {
+                    escaped = false;
+                }
+                else if (c == '\\')
+                {
+                    escaped = true;
+                }
+                else if (c == '"')
+                {
+                    in_string = false;
+                }
+                continue;
+            }
+            if (c == '"')
+            {
+                in_string = true;
+                has_member = true;
+            }
+            else if (c == '{' || c == '[')
+            {
+                ++nesting;
+            }
+            else if (c == '}' || c == ']')
+            {
+                if (nesting == 0)
+                {
+                    break;
+                }
+                --nesting;
+            }
+            else if (c == ',' && nesting == 0)
+            {
+                ++count;
+            }
+        }
+        return has_member ? count + 1 : 0;
+    }
+    else
+    {
+        return 0;
     }
-    ++begin;
-    return result;
 }
 
 template <typename FwIt> int ParseImpl<FwIt>::parse(Type<int>)
@@ -208,6 +440,55 @@ template <typename FwIt> std::string ParseImpl<FwIt>::parse(Type<std::string>)
     return result;
 }
 
+template <typename FwIt> void ParseImpl<FwIt>::enter_level()
+{
+    if (depth >= options.max_depth)
+    {
+        throw DepthLimitExceeded("Maximum nesting depth of " + std::to_string(options.max_depth) +
+                                 " exceeded in json input!");
+    }
+    ++depth;
+}
+
+template <typename FwIt> void ParseImpl<FwIt>::open_array()
+{
+    skip_until([](auto c) { return !is_white_space(c); });
+    if (begin == end)
+    {
+        throw ParseError("Unexpected end to the json input!");
+    }
+    if (*begin != '[')
+    {
+        throw_unexpected_character(*begin);
+    }
+    ++begin;
+}
+
+template <typename FwIt> bool ParseImpl<FwIt>::has_next_element()
+{
+    skip_until([](auto c) { return !is_white_space(c); });
+    if (begin == end)
+    {
+        throw ParseError("Unexpected end to the json input!");
+    }
+    if (*begin == ']')
+    {
+        ++begin;
+        return false;
+    }
+    return true;
+}
+
+template <typename FwIt> void ParseImpl<FwIt>::close_element()
+{
+    skip_until([](auto c) { return !is_white_space(c); });
+    if (begin == end)
+    {
+        throw ParseError("Unexpected end to the json input!");
+    }
+    assert_correct_value_end(']');
+}
+
 template <typename FwIt> template <typename TResult> TResult ParseImpl<FwIt>::parse_float()
 {
     skip_until([](auto c) { return !is_white_space(c); });
@@ -249,7 +530,6 @@ template <typename FwIt> template <typename T> void ParseImpl<FwIt>::init()
     static_assert(_private::IsJsonParseble<T>::value,
                   "Type must specify 'json_properties' static member "
                   "function to be used in this context!");
-    state = ParseState::Default;
     skip_until([](auto c) { return !is_white_space(c); });
     if (*begin != '{')
     {
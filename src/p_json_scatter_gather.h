@@ -0,0 +1,192 @@
+#pragma once
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/uio.h>)
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#define MINI_JSON_HAS_WRITEV 1
+#endif
+
+namespace mini_json
+{
+/**
+     Serializer output that collects segments instead of copying into a single buffer
+     Formatted output is appended to an internal scratch buffer,
+     strings of at least reference_threshold bytes that need no escaping
+     are referenced in place. Referenced strings must outlive the sink
+     */
+class ScatterGatherSink
+{
+    struct Segment
+    {
+        const char* external;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::string scratch;
+    std::vector<Segment> segment_list;
+    std::ostringstream formatter;
+    std::size_t reference_threshold;
+
+    void append(std::string_view bytes)
+    {
+        if (segment_list.empty() || segment_list.back().external != nullptr)
+        {
+            segment_list.push_back(Segment{nullptr, scratch.size(), 0});
+        }
+        scratch.append(bytes.data(), bytes.size());
+        segment_list.back().size += bytes.size();
+    }
+
+public:
+    explicit ScatterGatherSink(std::size_t reference_threshold = 1024)
+        : reference_threshold(reference_threshold)
+    {
+    }
+
+    ScatterGatherSink& operator<<(const char* bytes)
+    {
+        append(bytes);
+        return *this;
+    }
+
+    ScatterGatherSink& operator<<(char c)
+    {
+        append(std::string_view{&c, 1});
+        return *this;
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+    ScatterGatherSink& operator<<(T value)
+    {
+        formatter.str(std::string{});
+        formatter << value;
+        append(formatter.str());
+        return *this;
+    }
+
+    /// Writes item as a quoted json string, escaping like std::quoted
+    /// Large strings without escapes are referenced, so item must outlive the sink
+    void write_string(std::string const& item)
+    {
+        if (item.size() >= reference_threshold && item.find_first_of("\"\\") == std::string::npos)
+        {
+            append("\"");
+            segment_list.push_back(Segment{item.data(), 0, item.size()});
+            append("\"");
+            return;
+        }
+        write_string_copy(item);
+    }
+
+    /// Writes item as a quoted json string, always copying it into the scratch buffer
+    void write_string_copy(std::string_view item)
+    {
+        append("\"");
+        auto run_begin = std::size_t{0};
+        for (auto i = std::size_t{0}; i < item.size(); ++i)
+        {
+            if (item[i] == '"' || item[i] == '\\')
+            {
+                append(item.substr(run_begin, i - run_begin));
+                append("\\");
+                run_begin = i;
+            }
+        }
+        append(item.substr(run_begin));
+        append("\"");
+    }
+
+    /// The collected output in order, valid until the sink is modified
+    std::vector<std::string_view> segments() const
+    {
+        auto result = std::vector<std::string_view>{};
+        result.reserve(segment_list.size());
+        for (auto& segment : segment_list)
+        {
+            result.push_back(segment.external != nullptr
+                                 ? std::string_view{segment.external, segment.size}
+                                 : std::string_view{scratch}.substr(segment.offset, segment.size));
+        }
+        return result;
+    }
+
+    std::size_t size() const
+    {
+        auto result = std::size_t{0};
+        for (auto& segment : segment_list)
+        {
+            result += segment.size;
+        }
+        return result;
+    }
+
+    std::string str() const
+    {
+        auto result = std::string{};
+        result.reserve(size());
+        for (auto segment : segments())
+        {
+            result.append(segment.data(), segment.size());
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        scratch.clear();
+        segment_list.clear();
+    }
+
+#ifdef MINI_JSON_HAS_WRITEV
+    /// Writes all segments to fd with writev, throws std::system_error on failure
+    void write_to(int fd) const
+    {
+        auto vectors = std::vector<iovec>{};
+        vectors.reserve(segment_list.size());
+        for (auto segment : segments())
+        {
+            if (!segment.empty())
+            {
+                vectors.push_back(iovec{const_cast<char*>(segment.data()), segment.size()});
+            }
+        }
+        auto current = vectors.data();
+        auto remaining = vectors.size();
+        while (remaining > 0)
+        {
+            const auto count = static_cast<int>(remaining < IOV_MAX ? remaining : IOV_MAX);
+            auto written = ::writev(fd, current, count);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "writev");
+            }
+            auto done = static_cast<std::size_t>(written);
+            while (remaining > 0 && done >= current->iov_len)
+            {
+                done -= current->iov_len;
+                ++current;
+                --remaining;
+            }
+            if (remaining > 0)
+            {
+                current->iov_base = static_cast<char*>(current->iov_base) + done;
+                current->iov_len -= done;
+            }
+        }
+    }
+#endif
+};
+} // namespace mini_json
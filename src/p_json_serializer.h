@@ -1,13 +1,34 @@
 #pragma once
+#include "p_json_columns.h"
 #include "p_json_error.h"
+#include "p_json_flat_map.h"
 #include "p_json_utility.h"
 #include <iomanip>
+#include <map>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace mini_json::_private
 {
+/// Outputs providing write_string and write_string_copy receive strings unformatted,
+/// everything else is written through std::quoted
+template <typename TStream, typename = void> struct HasWriteString : std::false_type
+{
+};
+
+template <typename TStream>
+struct HasWriteString<
+    TStream,
+    std::void_t<decltype(std::declval<TStream&>().write_string(std::declval<std::string const&>())),
+                decltype(std::declval<TStream&>().write_string_copy(std::declval<const char*>()))>>
+    : std::true_type
+{
+};
+
 template <typename TStream> class SerializerImpl
 {
     TStream& stream;
@@ -19,24 +40,62 @@ public:
     }
 
     template <typename T> void serialize(T const& item)
+    {
+        serialize_object<T>([&](auto i) -> decltype(auto) {
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            return (item.*(property.member));
+        });
+    }
+
+    /// Serializes only the properties of current that differ from baseline
+    template <typename T> void serialize_diff(T const& current, T const& baseline)
     {
         stream << "{";
 
-        constexpr auto n_properties = std::tuple_size<decltype(T::json_properties())>::value;
+        constexpr auto n_properties = PropertyTable<T>::size;
 
         const char* separator = "";
         for_sequence(std::make_index_sequence<n_properties>{}, [&](auto i) {
-            constexpr auto property = std::get<i>(T::json_properties());
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            using PropertyType = typename decltype(property)::Type;
+            auto const& value = current.*(property.member);
+            auto const& base = baseline.*(property.member);
+            if (properties_equal(value, base))
+            {
+                return;
+            }
             stream << separator;
-            this->serialize(std::string{property.name});
+            serialize_key(property.name);
             stream << ":";
-            this->serialize(item.*(property.member));
+            if constexpr (IsJsonParseble<PropertyType>::value)
+            {
+                this->serialize_diff(value, base);
+            }
+            else
+            {
+                this->serialize(value);
+            }
             separator = ",";
         });
 
         stream << "}";
     }
 
+    template <typename T> void serialize(Columns<T> const& columns)
+    {
+        stream << "[";
+        const char* separator = "";
+        for (std::size_t row = 0; row < columns.size(); ++row)
+        {
+            stream << separator;
+            separator = ",";
+            serialize_object<T>([&](auto i) -> decltype(auto) {
+                return (columns.template column<i>()[row]);
+            });
+        }
+        stream << "]";
+    }
+
     template <typename T> void serialize(std::vector<T> const& items)
     {
         stream << "[";
@@ -50,9 +109,33 @@ public:
         stream << "]";
     }
 
+    template <typename V, typename Compare, typename Alloc>
+    void serialize(std::map<std::string, V, Compare, Alloc> const& items)
+    {
+        serialize_map(items);
+    }
+
+    template <typename V, typename Hash, typename Equal, typename Alloc>
+    void serialize(std::unordered_map<std::string, V, Hash, Equal, Alloc> const& items)
+    {
+        serialize_map(items);
+    }
+
+    template <typename V> void serialize(FlatMap<V> const& items)
+    {
+        serialize_map(items);
+    }
+
     void serialize(std::string const& item)
     {
-        stream << std::quoted(item);
+        if constexpr (HasWriteString<TStream>::value)
+        {
+            stream.write_string(item);
+        }
+        else
+        {
+            stream << std::quoted(item);
+        }
     }
 
     void serialize(int item)
@@ -74,6 +157,53 @@ public:
     {
         stream << item;
     }
+
+private:
+    void serialize_key(const char* name)
+    {
+        if constexpr (HasWriteString<TStream>::value)
+        {
+            stream.write_string_copy(name);
+        }
+        else
+        {
+            this->serialize(std::string{name});
+        }
+    }
+
+    template <typename Map> void serialize_map(Map const& items)
+    {
+        stream << "{";
+        const char* separator = "";
+        for (auto& item : items)
+        {
+            stream << separator;
+            separator = ",";
+            this->serialize(item.first);
+            stream << ":";
+            this->serialize(item.second);
+        }
+        stream << "}";
+    }
+
+    template <typename T, typename Fun> void serialize_object(Fun&& value_of)
+    {
+        stream << "{";
+
+        constexpr auto n_properties = PropertyTable<T>::size;
+
+        const char* separator = "";
+        for_sequence(std::make_index_sequence<n_properties>{}, [&](auto i) {
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            stream << separator;
+            serialize_key(property.name);
+            stream << ":";
+            this->serialize(value_of(i));
+            separator = ",";
+        });
+
+        stream << "}";
+    }
 };
 } // namespace mini_json::_private
 
@@ -1,7 +1,16 @@
 #pragma once
+#include "p_json_error.h"
+#include "p_json_flat_map.h"
+#include <array>
+#include <cstddef>
 #include <iostream>
+#include <map>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mini_json::_private
 {
@@ -23,6 +32,27 @@ template <typename T> struct Type
 {
 };
 
+template <typename Properties, std::size_t... I>
+constexpr std::array<const char*, sizeof...(I)> make_property_names(Properties const& properties,
+                                                                    std::index_sequence<I...>)
+{
+    return {{std::get<I>(properties).name...}};
+}
+
+/**
+     Properties of T and their names, evaluated once per type
+     and shared by every parse and serialize instantiation
+     */
+template <typename T> struct PropertyTable
+{
+    using Properties = decltype(T::json_properties());
+
+    constexpr static Properties properties = T::json_properties();
+    constexpr static std::size_t size = std::tuple_size<Properties>::value;
+    constexpr static std::array<const char*, size> names =
+        make_property_names(properties, std::make_index_sequence<size>{});
+};
+
 template <typename T, T... S, typename F>
 constexpr void for_sequence(std::integer_sequence<T, S...>, F&& f)
 {
@@ -40,22 +70,24 @@ constexpr auto str_equal(const char* lhs, const char* rhs)
     return *lhs == *rhs;
 }
 
-template <typename T, typename Fun> constexpr void executeByPropertyName(const char* name, Fun&& f)
+template <typename T, typename Fun>
+constexpr void executeByPropertyIndex(const char* name, Fun&& f)
 {
-    constexpr auto n_properties = std::tuple_size<decltype(T::json_properties())>::value;
-    auto found = false;
-    for_sequence(std::make_index_sequence<n_properties>{}, [&](auto i) {
-        constexpr auto property = std::get<i>(T::json_properties());
-        if (str_equal(property.name, name))
+    constexpr auto& names = PropertyTable<T>::names;
+    for (std::size_t index = 0; index < names.size(); ++index)
+    {
+        if (str_equal(names[index], name))
         {
-            found = true;
-            f(property);
+            for_sequence(std::make_index_sequence<PropertyTable<T>::size>{}, [&](auto i) {
+                if (i == index)
+                {
+                    f(i);
+                }
+            });
+            return;
         }
-    });
-    if (!found)
-    {
-        throw UnexpectedPropertyName(name);
     }
+    throw UnexpectedPropertyName(name);
 }
 
 template <typename T> class IsJsonParseble
@@ -67,10 +99,112 @@ template <typename T> class IsJsonParseble
     };
 
     template <typename C> static Yes test(decltype(&C::json_properties));
-    static No test(...);
+    template <typename C> static No test(...);
 
 public:
     constexpr static bool value = sizeof(test<T>(nullptr)) == sizeof(Yes);
 };
+
+template <typename T, typename = void> struct HasReserve : std::false_type
+{
+};
+
+template <typename T>
+struct HasReserve<T, std::void_t<decltype(std::declval<T&>().reserve(std::size_t{}))>>
+    : std::true_type
+{
+};
+
+/// Compares json properties member by member, recursing into nested objects, vectors and maps
+template <typename T> bool properties_equal(T const& lhs, T const& rhs);
+template <typename T> bool properties_equal(std::vector<T> const& lhs, std::vector<T> const& rhs);
+template <typename V, typename Compare, typename Alloc>
+bool properties_equal(std::map<std::string, V, Compare, Alloc> const& lhs,
+                      std::map<std::string, V, Compare, Alloc> const& rhs);
+template <typename V, typename Hash, typename Equal, typename Alloc>
+bool properties_equal(std::unordered_map<std::string, V, Hash, Equal, Alloc> const& lhs,
+                      std::unordered_map<std::string, V, Hash, Equal, Alloc> const& rhs);
+template <typename V> bool properties_equal(FlatMap<V> const& lhs, FlatMap<V> const& rhs);
+
+template <typename T>
+bool properties_equal(std::vector<T> const& lhs, std::vector<T> const& rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (!properties_equal(lhs[i], rhs[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Map> bool map_properties_equal(Map const& lhs, Map const& rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+    for (auto& entry : lhs)
+    {
+        auto other = rhs.find(entry.first);
+        if constexpr (std::is_pointer_v<decltype(other)>)
+        {
+            if (other == nullptr || !properties_equal(entry.second, *other))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if (other == rhs.end() || !properties_equal(entry.second, other->second))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename V, typename Compare, typename Alloc>
+bool properties_equal(std::map<std::string, V, Compare, Alloc> const& lhs,
+                      std::map<std::string, V, Compare, Alloc> const& rhs)
+{
+    return map_properties_equal(lhs, rhs);
+}
+
+template <typename V, typename Hash, typename Equal, typename Alloc>
+bool properties_equal(std::unordered_map<std::string, V, Hash, Equal, Alloc> const& lhs,
+                      std::unordered_map<std::string, V, Hash, Equal, Alloc> const& rhs)
+{
+    return map_properties_equal(lhs, rhs);
+}
+
+template <typename V> bool properties_equal(FlatMap<V> const& lhs, FlatMap<V> const& rhs)
+{
+    return map_properties_equal(lhs, rhs);
+}
+
+template <typename T> bool properties_equal(T const& lhs, T const& rhs)
+{
+    if constexpr (IsJsonParseble<T>::value)
+    {
+        constexpr auto n_properties = PropertyTable<T>::size;
+        auto equal = true;
+        for_sequence(std::make_index_sequence<n_properties>{}, [&](auto i) {
+            constexpr auto property = std::get<i>(PropertyTable<T>::properties);
+            equal = equal && properties_equal(lhs.*(property.member), rhs.*(property.member));
+        });
+        return equal;
+    }
+    else
+    {
+        return lhs == rhs;
+    }
+}
 } // namespace mini_json::_private
 
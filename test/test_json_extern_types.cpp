@@ -0,0 +1,4 @@
+#include "test_json_extern_types.h"
+
+// the only translation unit that compiles parse and serialize for the types in the header
+MINI_JSON_INSTANTIATE_TYPE(extern_types::Pear)
@@ -0,0 +1,20 @@
+#pragma once
+#include "json.h"
+#include <string>
+
+namespace extern_types
+{
+struct Pear
+{
+    std::string color = "";
+    int size = 0;
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Pear::color, "color"),
+                               mini_json::property(&Pear::size, "size"));
+    }
+};
+} // namespace extern_types
+
+MINI_JSON_EXTERN_TYPE(extern_types::Pear)
@@ -0,0 +1,113 @@
+#include "json.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mini_json;
+using namespace std::string_literals;
+
+namespace
+{
+struct Seed
+{
+    float radius = 0.0;
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Seed::radius, "radius"));
+    }
+};
+
+TEST(TestJsonParseCache, ReturnsSharedValueForIdenticalInput)
+{
+    auto cache = mini_json::ParseCache<Seed>(8);
+
+    const auto json = R"({"radius": 1.5})"s;
+    auto first = cache.parse(json);
+    auto second = cache.parse(std::string{json});
+
+    EXPECT_FLOAT_EQ(first->radius, 1.5f);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(TestJsonParseCache, ParsesDistinctInputsSeparately)
+{
+    auto cache = mini_json::ParseCache<Seed>(8);
+
+    auto first = cache.parse(R"({"radius": 1})");
+    auto second = cache.parse(R"({"radius": 2})");
+
+    EXPECT_NE(first, second);
+    EXPECT_FLOAT_EQ(first->radius, 1.0f);
+    EXPECT_FLOAT_EQ(second->radius, 2.0f);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(TestJsonParseCache, EvictsLeastRecentlyUsedEntry)
+{
+    auto cache = mini_json::ParseCache<Seed, 1>(2);
+
+    auto first = cache.parse(R"({"radius": 1})");
+    auto second = cache.parse(R"({"radius": 2})");
+    EXPECT_EQ(cache.parse(R"({"radius": 1})"), first);
+
+    cache.parse(R"({"radius": 3})");
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.parse(R"({"radius": 1})"), first);
+    EXPECT_NE(cache.parse(R"({"radius": 2})"), second);
+}
+
+TEST(TestJsonParseCache, NeverExceedsCapacity)
+{
+    for (auto capacity : {0u, 1u, 5u, 20u})
+    {
+        auto cache = mini_json::ParseCache<Seed>(capacity);
+        for (int i = 0; i < 40; ++i)
+        {
+            auto seed = cache.parse("{\"radius\":" + std::to_string(i) + "}");
+            EXPECT_FLOAT_EQ(seed->radius, float(i));
+        }
+        EXPECT_LE(cache.size(), capacity);
+    }
+
+    auto cache = mini_json::ParseCache<Seed>(1);
+    auto first = cache.parse(R"({"radius": 1})");
+    EXPECT_EQ(cache.parse(R"({"radius": 1})"), first);
+    cache.parse(R"({"radius": 2})");
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_NE(cache.parse(R"({"radius": 1})"), first);
+}
+
+TEST(TestJsonParseCache, DoesNotCacheInvalidInput)
+{
+    auto cache = mini_json::ParseCache<Seed>(8);
+
+    EXPECT_THROW(cache.parse(R"({"fakeproperty": 1})"), mini_json::UnexpectedPropertyName);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(TestJsonParseCache, CanBeSharedBetweenThreads)
+{
+    auto cache = mini_json::ParseCache<Seed>(256);
+
+    auto threads = std::vector<std::thread>{};
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&cache] {
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto json = "{\"radius\":" + std::to_string(i % 16) + "}";
+                auto seed = cache.parse(json);
+                EXPECT_FLOAT_EQ(seed->radius, float(i % 16));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(cache.size(), 16u);
+}
+} // namespace
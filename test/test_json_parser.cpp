@@ -247,4 +247,314 @@ TEST_F(TestJsonParser, RaisesExceptionIfCommaIsMissingInDict)
     const auto json = "{\"x\": 1 \"y\": 2}"s;
     EXPECT_THROW(mini_json::parse<Simple>(json.begin(), json.end()), mini_json::ParseError);
 }
+
+struct Node
+{
+    int value = 0;
+    std::vector<Node> children = {};
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Node::value, "value"),
+                               mini_json::property(&Node::children, "children"));
+    }
+};
+
+std::string nested_nodes(int levels)
+{
+    auto json = std::string{};
+    for (int i = 0; i < levels; ++i)
+    {
+        json += "{\"value\":" + std::to_string(i) + ",\"children\":[";
+    }
+    for (int i = 0; i < levels; ++i)
+    {
+        json += "]}";
+    }
+    return json;
+}
+
+TEST_F(TestJsonParser, CanReadRecursiveTypesWithinDepthLimit)
+{
+    const auto json = nested_nodes(10);
+
+    auto result = mini_json::parse<Node>(json.begin(), json.end());
+
+    auto* node = &result;
+    for (int i = 0; i < 9; ++i)
+    {
+        EXPECT_EQ(node->value, i);
+        ASSERT_EQ(node->children.size(), 1u);
+        node = &node->children.front();
+    }
+    EXPECT_EQ(node->value, 9);
+    EXPECT_TRUE(node->children.empty());
+}
+
+TEST_F(TestJsonParser, RaisesExceptionIfDepthLimitIsExceeded)
+{
+    const auto json = nested_nodes(10);
+
+    auto options = mini_json::ParseOptions{};
+    // every node is an object holding an array: two levels per node
+    options.max_depth = 19;
+    EXPECT_THROW(mini_json::parse<Node>(json.begin(), json.end(), options),
+                 mini_json::DepthLimitExceeded);
+
+    options.max_depth = 20;
+    EXPECT_NO_THROW(mini_json::parse<Node>(json.begin(), json.end(), options));
+}
+
+TEST_F(TestJsonParser, DefaultDepthLimitGuardsAgainstDeepInput)
+{
+    const auto json = nested_nodes(100000);
+    EXPECT_THROW(mini_json::parse<Node>(json.begin(), json.end()), mini_json::DepthLimitExceeded);
+}
+
+TEST_F(TestJsonParser, CanStreamArrayElements)
+{
+    const auto json = R"a([
+              {"color":"red","size":0,"seed":{"radius":0}},
+              {"color":"red","size":1,"seed":{"radius":1}},
+              {"color":"red","size":2,"seed":{"radius":2}}
+        ])a"s;
+
+    int i = 0;
+    for (auto& apple : mini_json::stream_array<Apple>(json.begin(), json.end()))
+    {
+        EXPECT_EQ(apple.color, "red");
+        EXPECT_EQ(apple.size, i);
+        EXPECT_FLOAT_EQ(apple.seed.radius, float(i));
+        ++i;
+    }
+    EXPECT_EQ(i, 3);
+}
+
+TEST_F(TestJsonParser, CanStreamArrayElementsFromStreams)
+{
+    auto stream = std::stringstream();
+    stream << "[1, 2, 3, 4]";
+
+    auto result = std::vector<int>{};
+    for (auto n : mini_json::stream_array<int>(stream))
+    {
+        result.push_back(n);
+    }
+    EXPECT_EQ(result, (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST_F(TestJsonParser, CanStreamEmptyArray)
+{
+    const auto json = "[ ]"s;
+    auto stream = mini_json::stream_array<Apple>(json.begin(), json.end());
+    EXPECT_EQ(stream.begin(), stream.end());
+}
+
+TEST_F(TestJsonParser, StreamingArrayStopsParsingOnBreak)
+{
+    const auto json = R"a([
+              {"color":"red","size":0,"seed":{"radius":0}},
+              {"color":"red","size":1,"seed":{"radius":1}},
+              {"fakeproperty": "asd"}
+        ])a"s;
+
+    auto count = 0;
+    EXPECT_NO_THROW({
+        for (auto& apple : mini_json::stream_array<Apple>(json.begin(), json.end()))
+        {
+            ++count;
+            if (apple.size == 1)
+            {
+                break;
+            }
+        }
+    });
+    EXPECT_EQ(count, 2);
+
+    EXPECT_THROW(
+        {
+            for (auto& apple : mini_json::stream_array<Apple>(json.begin(), json.end()))
+            {
+                (void)apple;
+            }
+        },
+        mini_json::UnexpectedPropertyName);
+}
+
+TEST_F(TestJsonParser, CanReadArrayIntoColumns)
+{
+    const auto json = R"a([
+              {"color":"red","size":0,"seed":{"radius":0}},
+              {"color":"green","size":1,"seed":{"radius":1}},
+              {"size":2,"color":"blue"}
+        ])a"s;
+
+    auto result = mini_json::parse_columns<Apple>(json.begin(), json.end());
+
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_EQ(result.column(&Apple::color), (std::vector<std::string>{"red", "green", "blue"}));
+    EXPECT_EQ(result.column(&Apple::size), (std::vector<int>{0, 1, 2}));
+    ASSERT_EQ(result.column(&Apple::seed).size(), 3u);
+    EXPECT_FLOAT_EQ(result.column(&Apple::seed)[1].radius, 1.0f);
+    EXPECT_FLOAT_EQ(result.column(&Apple::seed)[2].radius, 0.0f);
+
+    auto apple = result.row(1);
+    EXPECT_EQ(apple.color, "green");
+    EXPECT_EQ(apple.size, 1);
+}
+
+TEST_F(TestJsonParser, ColumnsRejectMembersThatAreNotProperties)
+{
+    struct Partial
+    {
+        int x = 0;
+        int y = 0;
+
+        constexpr static auto json_properties()
+        {
+            return std::make_tuple(mini_json::property(&Partial::x, "x"));
+        }
+    };
+
+    auto columns = mini_json::Columns<Partial>{};
+    EXPECT_NO_THROW(columns.column(&Partial::x));
+    EXPECT_THROW(columns.column(&Partial::y), std::invalid_argument);
+}
+
+TEST_F(TestJsonParser, PatchUpdatesOnlyPresentProperties)
+{
+    auto apple = Apple{"red", 5, Seed{1.5f}};
+
+    const auto json = R"a({"seed": {"radius": 2.5}, "size": 6})a"s;
+    mini_json::apply_patch(json.begin(), json.end(), apple);
+
+    EXPECT_EQ(apple.color, "red");
+    EXPECT_EQ(apple.size, 6);
+    EXPECT_FLOAT_EQ(apple.seed.radius, 2.5f);
+}
+
+TEST_F(TestJsonParser, PatchRaisesExceptionIfNonExistentPropertyIsRead)
+{
+    auto apple = Apple{};
+    const auto json = R"a({"fakeproperty": "asd"})a"s;
+    EXPECT_THROW(mini_json::apply_patch(json.begin(), json.end(), apple),
+                 mini_json::UnexpectedPropertyName);
+}
+
+struct Users
+{
+    std::unordered_map<std::string, Apple> by_id = {};
+    std::map<std::string, int> scores = {};
+    mini_json::FlatMap<std::string> tags = {};
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Users::by_id, "by_id"),
+                               mini_json::property(&Users::scores, "scores"),
+                               mini_json::property(&Users::tags, "tags"));
+    }
+};
+
+TEST_F(TestJsonParser, CanReadMapsWithDynamicKeys)
+{
+    const auto json = R"a({
+        "by_id": {
+            "user123": {"color":"red","size":1,"seed":{"radius":1}},
+            "user,456": {"color":"green","size":2,"seed":{"radius":2}}
+        },
+        "scores": {"b": 2, "a": 1},
+        "tags": {"x": "1", "y": "{[\"]}", "z": "3"}
+    })a"s;
+
+    auto result = mini_json::parse<Users>(json.begin(), json.end());
+
+    ASSERT_EQ(result.by_id.size(), 2u);
+    EXPECT_EQ(result.by_id.at("user123").color, "red");
+    EXPECT_EQ(result.by_id.at("user,456").size, 2);
+    EXPECT_EQ(result.scores, (std::map<std::string, int>{{"a", 1}, {"b", 2}}));
+    ASSERT_EQ(result.tags.size(), 3u);
+    EXPECT_EQ(result.tags.at("y"), "{[\"]}");
+    EXPECT_FALSE(result.tags.contains("w"));
+}
+
+TEST_F(TestJsonParser, CanReadEmptyMapsFromStreams)
+{
+    auto stream = std::stringstream();
+    stream << R"a({"by_id": { }, "scores": {}, "tags": {"k": "v"}})a";
+
+    auto result = mini_json::parse<Users>(stream);
+
+    EXPECT_TRUE(result.by_id.empty());
+    EXPECT_TRUE(result.scores.empty());
+    EXPECT_EQ(result.tags.at("k"), "v");
+}
+
+TEST_F(TestJsonParser, RaisesExceptionIfMapIsMalformed)
+{
+    auto json = R"a({"scores": {"a" 1}})a"s;
+    EXPECT_THROW(mini_json::parse<Users>(json.begin(), json.end()), mini_json::ParseError);
+
+    json = R"a({"scores": {"a": 1 "b": 2}})a"s;
+    EXPECT_THROW(mini_json::parse<Users>(json.begin(), json.end()), mini_json::ParseError);
+
+    json = R"a({"scores": {"a": 1)a"s;
+    EXPECT_THROW(mini_json::parse<Users>(json.begin(), json.end()), mini_json::ParseError);
+
+    // not NUL terminated, so reading past the end is caught by sanitizers
+    const auto truncated = std::string(R"a({"scores":   )a");
+    const auto buffer = std::vector<char>(truncated.begin(), truncated.end());
+    EXPECT_THROW(mini_json::parse<Users>(buffer.begin(), buffer.end()), mini_json::ParseError);
+}
+
+TEST(TestFlatMap, InsertsAndFindsKeys)
+{
+    auto map = mini_json::FlatMap<int>{};
+    for (int i = 0; i < 100; ++i)
+    {
+        map.insert_or_assign(std::to_string(i), i);
+    }
+    map.insert_or_assign("42", -42);
+
+    ASSERT_EQ(map.size(), 100u);
+    EXPECT_EQ(map.at("42"), -42);
+    EXPECT_EQ(map.at("99"), 99);
+    EXPECT_EQ(map.find("100"), nullptr);
+    EXPECT_THROW(map.at("100"), std::out_of_range);
+    EXPECT_EQ(map.begin()->first, "0");
+}
+
+TEST_F(TestJsonParser, StreamedArrayCountsTowardsDepthLimit)
+{
+    const auto json = R"a([{"radius": 1}])a"s;
+
+    auto options = mini_json::ParseOptions{};
+    options.max_depth = 1;
+    EXPECT_THROW(mini_json::stream_array<Seed>(json.begin(), json.end(), options).begin(),
+                 mini_json::DepthLimitExceeded);
+    EXPECT_THROW(mini_json::parse_columns<Seed>(json.begin(), json.end(), options),
+                 mini_json::DepthLimitExceeded);
+
+    options.max_depth = 2;
+    auto count = 0;
+    for (auto& seed : mini_json::stream_array<Seed>(json.begin(), json.end(), options))
+    {
+        EXPECT_FLOAT_EQ(seed.radius, 1.0f);
+        ++count;
+    }
+    EXPECT_EQ(count, 1);
+    EXPECT_NO_THROW(mini_json::parse_columns<Seed>(json.begin(), json.end(), options));
+}
+
+TEST_F(TestJsonParser, StreamingEmptyInputRaisesParseError)
+{
+    const auto buffer = std::vector<char>{' ', '\n', '\t'};
+    EXPECT_THROW(mini_json::stream_array<Seed>(buffer.begin(), buffer.end()).begin(),
+                 mini_json::ParseError);
+
+    auto stream = std::stringstream();
+    EXPECT_THROW(mini_json::stream_array<Seed>(stream).begin(), mini_json::ParseError);
+
+    stream << "   ";
+    EXPECT_THROW(mini_json::stream_array<Seed>(stream).begin(), mini_json::ParseError);
+}
 }
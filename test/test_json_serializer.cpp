@@ -1,9 +1,15 @@
 #include "json.h"
+#include "test_json_extern_types.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
 
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
 using namespace mini_json;
 using namespace std::string_literals;
 
@@ -74,5 +80,246 @@ TEST_F(TestJsonSerializer, ParsedSerializationEqualsOriginal)
     auto result = mini_json::parse<AppleTree>(jsonStr.begin(), jsonStr.end());
     EXPECT_EQ(result, tree);
 }
+
+TEST_F(TestJsonSerializer, ColumnsSerializeAsArrayOfObjects)
+{
+    auto columns = mini_json::Columns<Apple>();
+    for (auto& apple : tree.apples) {
+        columns.push_back(apple);
+    }
+
+    auto json = std::stringstream();
+    mini_json::serialize(columns, json);
+    EXPECT_EQ(json.str(), R"([{"color":"red","size":0},{"color":"blue","size":1},{"color":"green","size":2}])");
+
+    auto jsonStr = json.str();
+    auto result = mini_json::parse_columns<Apple>(jsonStr.begin(), jsonStr.end());
+    ASSERT_EQ(result.size(), tree.apples.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result.row(i), tree.apples[i]);
+    }
+}
+
+struct Basket {
+    std::string owner = "";
+    Apple apple = {};
+    int count = 0;
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Basket::owner, "owner"),
+            mini_json::property(&Basket::apple, "apple"),
+            mini_json::property(&Basket::count, "count"));
+    }
+};
+
+TEST_F(TestJsonSerializer, DiffOfEqualObjectsIsEmpty)
+{
+    auto json = std::stringstream();
+    mini_json::serialize_diff(tree, tree, json);
+    EXPECT_EQ(json.str(), "{}");
+}
+
+TEST_F(TestJsonSerializer, DiffContainsOnlyChangedProperties)
+{
+    auto baseline = Basket { "alice"s, Apple { "red"s, 1 }, 3 };
+    auto current = baseline;
+    current.apple.size = 2;
+    current.count = 4;
+
+    auto json = std::stringstream();
+    mini_json::serialize_diff(current, baseline, json);
+    EXPECT_EQ(json.str(), R"({"apple":{"size":2},"count":4})");
 }
 
+TEST_F(TestJsonSerializer, DiffWritesChangedVectorsInFull)
+{
+    auto current = tree;
+    current.apples[1].size = 42;
+
+    auto json = std::stringstream();
+    mini_json::serialize_diff(current, tree, json);
+    EXPECT_EQ(json.str(), R"({"apples":[{"color":"red","size":0},{"color":"blue","size":42},{"color":"green","size":2}]})");
+}
+
+TEST_F(TestJsonSerializer, AppliedDiffReproducesCurrent)
+{
+    auto current = tree;
+    current.id = "new_id"s;
+    current.apples.push_back(Apple { "yellow"s, 3 });
+
+    auto json = std::stringstream();
+    mini_json::serialize_diff(current, tree, json);
+
+    auto jsonStr = json.str();
+    auto patched = tree;
+    mini_json::apply_patch(jsonStr.begin(), jsonStr.end(), patched);
+    EXPECT_EQ(patched, current);
+    EXPECT_EQ(patched.apples.size(), current.apples.size());
+}
+
+TEST_F(TestJsonSerializer, ScatterGatherOutputEqualsStreamOutput)
+{
+    tree.apples.push_back(Apple { "with \"quotes\" and \\"s, 3 });
+
+    auto expected = std::stringstream();
+    mini_json::serialize(tree, expected);
+
+    auto sink = mini_json::ScatterGatherSink(4);
+    mini_json::serialize(tree, sink);
+    EXPECT_EQ(sink.str(), expected.str());
+    EXPECT_EQ(sink.size(), expected.str().size());
+}
+
+struct StringOnlySink {
+    void write_string(std::string const&) { }
+};
+
+struct StringSink : StringOnlySink {
+    void write_string_copy(std::string_view) { }
+};
+
+TEST_F(TestJsonSerializer, StringSinksMustProvideBothEntryPoints)
+{
+    EXPECT_FALSE(mini_json::_private::HasWriteString<std::stringstream>::value);
+    EXPECT_FALSE(mini_json::_private::HasWriteString<StringOnlySink>::value);
+    EXPECT_TRUE(mini_json::_private::HasWriteString<StringSink>::value);
+    EXPECT_TRUE(mini_json::_private::HasWriteString<mini_json::ScatterGatherSink>::value);
+}
+
+TEST_F(TestJsonSerializer, ScatterGatherReferencesLargeStrings)
+{
+    tree.id = std::string(4096, 'x');
+
+    auto sink = mini_json::ScatterGatherSink();
+    mini_json::serialize(tree, sink);
+
+    auto segments = sink.segments();
+    auto referenced = std::find_if(segments.begin(), segments.end(),
+        [&](auto segment) { return segment.data() == tree.id.data(); });
+    ASSERT_NE(referenced, segments.end());
+    EXPECT_EQ(referenced->size(), tree.id.size());
+}
+
+#if __has_include(<unistd.h>)
+TEST_F(TestJsonSerializer, ScatterGatherWritesToFileDescriptor)
+{
+    tree.id = std::string(8192, 'y');
+
+    auto sink = mini_json::ScatterGatherSink();
+    mini_json::serialize(tree, sink);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    sink.write_to(fds[1]);
+    close(fds[1]);
+
+    auto written = std::string();
+    char buffer[4096];
+    for (auto n = read(fds[0], buffer, sizeof(buffer)); n > 0; n = read(fds[0], buffer, sizeof(buffer))) {
+        written.append(buffer, static_cast<std::size_t>(n));
+    }
+    close(fds[0]);
+
+    auto expected = std::stringstream();
+    mini_json::serialize(tree, expected);
+    EXPECT_EQ(written, expected.str());
+}
+#endif
+
+struct Inventory {
+    std::map<std::string, Apple> apples = {};
+    std::unordered_map<std::string, int> counts = {};
+    mini_json::FlatMap<std::vector<int>> batches = {};
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Inventory::apples, "apples"),
+            mini_json::property(&Inventory::counts, "counts"),
+            mini_json::property(&Inventory::batches, "batches"));
+    }
+};
+
+TEST_F(TestJsonSerializer, SerializesMaps)
+{
+    auto inventory = Inventory();
+    inventory.apples = { { "b", Apple { "blue"s, 1 } }, { "a", Apple { "red"s, 0 } } };
+    inventory.counts = { { "only", 3 } };
+    inventory.batches.insert_or_assign("second", { 2, 3 });
+    inventory.batches.insert_or_assign("first", { 1 });
+
+    auto json = std::stringstream();
+    mini_json::serialize(inventory, json);
+    EXPECT_EQ(json.str(), R"({"apples":{"a":{"color":"red","size":0},"b":{"color":"blue","size":1}},)"
+                          R"("counts":{"only":3},"batches":{"second":[2,3],"first":[1]}})");
+
+    auto jsonStr = json.str();
+    auto result = mini_json::parse<Inventory>(jsonStr.begin(), jsonStr.end());
+    EXPECT_EQ(result.apples, inventory.apples);
+    EXPECT_EQ(result.counts, inventory.counts);
+    EXPECT_EQ(result.batches, inventory.batches);
+}
+
+TEST_F(TestJsonSerializer, ExplicitlyInstantiatedTypesRoundTrip)
+{
+    auto json = std::stringstream();
+    mini_json::serialize(extern_types::Pear { "yellow"s, 7 }, json);
+    EXPECT_EQ(json.str(), R"({"color":"yellow","size":7})");
+
+    auto result = mini_json::parse<extern_types::Pear>(json);
+    EXPECT_EQ(result.color, "yellow");
+    EXPECT_EQ(result.size, 7);
+}
+
+struct Plum {
+    int size = 0;
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&Plum::size, "size"));
+    }
+};
+
+struct PlumTree {
+    std::map<std::string, Plum> sorted = {};
+    std::unordered_map<std::string, Plum> hashed = {};
+    mini_json::FlatMap<Plum> flat = {};
+    std::vector<std::map<std::string, Plum>> nested = {};
+
+    constexpr static auto json_properties()
+    {
+        return std::make_tuple(mini_json::property(&PlumTree::sorted, "sorted"),
+            mini_json::property(&PlumTree::hashed, "hashed"),
+            mini_json::property(&PlumTree::flat, "flat"),
+            mini_json::property(&PlumTree::nested, "nested"));
+    }
+};
+
+TEST_F(TestJsonSerializer, DiffComparesMapsOfObjectsWithoutEqualityOperator)
+{
+    auto baseline = PlumTree();
+    baseline.sorted = { { "a", Plum { 1 } } };
+    baseline.hashed = { { "b", Plum { 2 } } };
+    baseline.flat.insert_or_assign("c", Plum { 3 });
+    baseline.nested = { { { "d", Plum { 4 } } } };
+
+    auto json = std::stringstream();
+    mini_json::serialize_diff(baseline, baseline, json);
+    EXPECT_EQ(json.str(), "{}");
+
+    auto current = baseline;
+    current.hashed.at("b").size = 20;
+    current.flat.insert_or_assign("e", Plum { 5 });
+
+    json = std::stringstream();
+    mini_json::serialize_diff(current, baseline, json);
+    EXPECT_EQ(json.str(), R"({"hashed":{"b":{"size":20}},"flat":{"c":{"size":3},"e":{"size":5}}})");
+
+    auto jsonStr = json.str();
+    auto patched = baseline;
+    mini_json::apply_patch(jsonStr.begin(), jsonStr.end(), patched);
+    EXPECT_EQ(patched.hashed.at("b").size, 20);
+    EXPECT_EQ(patched.flat.at("e").size, 5);
+    EXPECT_EQ(patched.sorted.at("a").size, 1);
+}
+}